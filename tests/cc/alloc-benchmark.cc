@@ -1,12 +1,16 @@
 #include <nexus/test.hh>
 
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <ctracer/benchmark.hh>
 
 #include <clean-core/allocate.hh>
+#include <clean-core/allocator.hh>
 #include <clean-core/array.hh>
 
 #define DO_BENCHMARK 0
@@ -65,6 +69,27 @@ void measure(std::string name, size_t samples, F&& f)
     return measure(name, samples, f, [] {});
 }
 
+// runs f(thread_index) on num_threads threads at once and reports the combined throughput
+// f has to perform samples_per_thread allocations
+template <class F>
+void measure_mt(std::string name, unsigned num_threads, size_t samples_per_thread, F&& f)
+{
+    auto const t0 = std::chrono::high_resolution_clock::now();
+
+    std::vector<std::thread> threads;
+    for (auto t = 0u; t < num_threads; ++t)
+        threads.emplace_back([&f, t] { f(t); });
+    for (auto& thread : threads)
+        thread.join();
+
+    auto const seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - t0).count();
+    std::cout << name << " (" << num_threads << " threads): " << double(num_threads) * samples_per_thread / seconds / 1e6 << " M allocs / s"
+              << std::endl;
+}
+
+// mixed small sizes, as typical for node and string allocations
+size_t mixed_size(size_t i) { return 8 + (i * 7919) % 248; }
+
 }
 TEST("cc::alloc benchmark")
 {
@@ -178,3 +203,125 @@ TEST("cc::alloc benchmark")
         }
     });
 }
+
+TEST("cc::alloc multi-threaded benchmark")
+{
+#if !DO_BENCHMARK
+    CHECK(true);
+    return;
+#endif
+
+    // every thread keeps a window of live allocations and frees them in allocation order,
+    // so the allocator sees interleaved alloc/free traffic from all threads
+    auto constexpr samples_per_thread = 1'000'000u;
+    auto constexpr live_window = 1024u;
+
+    // powers of two, always including the full core count
+    auto const max_threads = std::thread::hardware_concurrency() > 0 ? std::thread::hardware_concurrency() : 1u;
+    for (auto num_threads = 1u;; num_threads = num_threads * 2 < max_threads ? num_threads * 2 : max_threads)
+    {
+        measure_mt("new/delete mixed sizes", num_threads, samples_per_thread, [&](unsigned) {
+            std::vector<char*> live(live_window, nullptr);
+            for (auto i = 0u; i < samples_per_thread; ++i)
+            {
+                auto& slot = live[i % live_window];
+                delete[] slot;
+                slot = new char[mixed_size(i)];
+                ct::sink << slot;
+            }
+            for (auto p : live)
+                delete[] p;
+        });
+        measure_mt("cc::system_allocator mixed sizes", num_threads, samples_per_thread, [&](unsigned) {
+            std::vector<std::byte*> live(live_window, nullptr);
+            for (auto i = 0u; i < samples_per_thread; ++i)
+            {
+                auto& slot = live[i % live_window];
+                if (slot)
+                    cc::system_allocator->free(slot);
+                slot = cc::system_allocator->alloc(mixed_size(i));
+                ct::sink << slot;
+            }
+            for (auto p : live)
+                if (p)
+                    cc::system_allocator->free(p);
+        });
+        measure_mt("cc::alloc array<int, 16>", num_threads, samples_per_thread, [&](unsigned) {
+            std::vector<cc::array<int, 16>*> live(live_window, nullptr);
+            for (auto i = 0u; i < samples_per_thread; ++i)
+            {
+                auto& slot = live[i % live_window];
+                if (slot)
+                    cc::free(slot);
+                slot = cc::alloc<cc::array<int, 16>>();
+                ct::sink << slot;
+            }
+            for (auto p : live)
+                if (p)
+                    cc::free(p);
+        });
+
+        if (num_threads >= max_threads)
+            break;
+    }
+}
+
+TEST("cc::alloc worst-case latency benchmark")
+{
+#if !DO_BENCHMARK
+    CHECK(true);
+    return;
+#endif
+
+    // random sizes and out-of-order frees, the case real-time paths care about
+    // reports tail latencies of single operations instead of averages
+    auto constexpr num_samples = 200'000u;
+    auto constexpr live_window = 4096u;
+
+    auto const report = [](std::string const& name, std::vector<uint64_t>& cycles) {
+        std::sort(cycles.begin(), cycles.end());
+        std::cout << name << ": p50 " << cycles[cycles.size() / 2] << ", p99.9 " << cycles[cycles.size() * 999 / 1000] << ", max " << cycles.back()
+                  << " cycles" << std::endl;
+    };
+
+    auto const measure_latencies = [&](std::string const& name, auto&& alloc_fun, auto&& free_fun) {
+        std::vector<uint64_t> alloc_cycles;
+        std::vector<uint64_t> free_cycles;
+        alloc_cycles.reserve(num_samples);
+        free_cycles.reserve(num_samples);
+
+        std::vector<std::byte*> live(live_window, nullptr);
+        uint64_t rng_state = 0x853c49e6748fea9bull;
+        for (auto i = 0u; i < num_samples; ++i)
+        {
+            // xorshift64
+            rng_state ^= rng_state << 13;
+            rng_state ^= rng_state >> 7;
+            rng_state ^= rng_state << 17;
+
+            auto& slot = live[rng_state % live_window];
+            if (slot)
+            {
+                auto const c = ct::current_cycles();
+                free_fun(slot);
+                free_cycles.push_back(ct::current_cycles() - c);
+            }
+
+            auto const size = 16 + (rng_state >> 32) % (64 * 1024);
+            auto const c = ct::current_cycles();
+            slot = alloc_fun(size);
+            alloc_cycles.push_back(ct::current_cycles() - c);
+        }
+        for (auto p : live)
+            if (p)
+                free_fun(p);
+
+        report(name + " alloc", alloc_cycles);
+        report(name + " free", free_cycles);
+    };
+
+    measure_latencies(
+        "new/delete", [](size_t size) { return new std::byte[size]; }, [](std::byte* p) { delete[] p; });
+    measure_latencies(
+        "cc::system_allocator", [](size_t size) { return cc::system_allocator->alloc(size); }, [](std::byte* p) { cc::system_allocator->free(p); });
+}
@@ -0,0 +1,244 @@
+#include <nexus/test.hh>
+
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+#include <ctracer/benchmark.hh>
+
+#include <clean-core/hash.hh>
+#include <clean-core/span.hh>
+#include <clean-core/string.hh>
+#include <clean-core/string_view.hh>
+#include <clean-core/to_string.hh>
+
+#define DO_BENCHMARK 0
+
+namespace
+{
+size_t const blob_sizes[] = {8, 16, 64, 256, 4 * 1024, 64 * 1024};
+
+auto constexpr bytes_per_size = 64u * 1024u * 1024u;
+
+// how byte blobs are hashed with cc today: combining 8 byte words
+uint64_t hash_blob_words(std::byte const* data, size_t size)
+{
+    auto h = cc::hash_combine();
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8)
+    {
+        uint64_t word;
+        std::memcpy(&word, data + i, 8);
+        h = cc::hash_combine(h, cc::make_hash(word));
+    }
+    for (; i < size; ++i)
+        h = cc::hash_combine(h, cc::make_hash(uint8_t(data[i])));
+    return h;
+}
+
+template <class F>
+void measure_throughput(char const* name, size_t size, std::vector<std::byte> const& data, F&& hash_fun)
+{
+    auto const num_hashes = bytes_per_size / size;
+
+    uint64_t sink = 0;
+    auto const c = ct::current_cycles();
+    for (auto i = 0u; i < num_hashes; ++i)
+        sink += hash_fun(data.data() + (i * size) % (data.size() - size), size);
+    auto const cycles = ct::current_cycles() - c;
+    ct::sink << sink;
+
+    std::cout << name << " (" << size << " bytes): " << double(cycles) / double(num_hashes * size) << " cycles / byte, "
+              << double(cycles) / double(num_hashes) << " cycles / hash" << std::endl;
+}
+
+// true if hash_fun depends on the bytes only, not on where they are stored
+// views are trivially copyable themselves and might end up hashing their pointer and size instead
+template <class F>
+bool hashes_content(F&& hash_fun)
+{
+    auto constexpr size = 64u;
+    std::byte a[size];
+    std::byte b[size];
+    for (auto i = 0u; i < size; ++i)
+        a[i] = b[i] = std::byte(i * 31);
+
+    if (hash_fun(a, size) != hash_fun(b, size))
+        return false;
+
+    b[17] ^= std::byte(1);
+    return hash_fun(a, size) != hash_fun(b, size);
+}
+
+// views of byte blobs are only measured if they are hashed by content
+template <class F>
+void measure_content_throughput(char const* name, size_t size, std::vector<std::byte> const& data, F&& hash_fun)
+{
+    if (hashes_content(hash_fun))
+        measure_throughput(name, size, data, hash_fun);
+    else
+        std::cout << name << ": not hashable by content" << std::endl;
+}
+
+template <class Span>
+void measure_span_throughput(char const* name, size_t size, std::vector<std::byte> const& data)
+{
+    if constexpr (cc::can_hash<Span>)
+        measure_content_throughput(name, size, data, [](std::byte const* d, size_t s) { return cc::make_hash(Span(d, s)); });
+    else
+        std::cout << name << ": not hashable" << std::endl;
+}
+
+// trivially hashable structs, as used for PSO and resource keys
+struct trivial_16
+{
+    uint64_t a;
+    uint64_t b;
+};
+struct trivial_64
+{
+    uint64_t v[8];
+};
+
+template <class T>
+void measure_struct_throughput(char const* name, std::vector<std::byte> const& data)
+{
+    static_assert(cc::can_hash<T>);
+
+    auto const num_structs = data.size() / sizeof(T);
+    std::vector<T> structs(num_structs);
+    std::memcpy(structs.data(), data.data(), num_structs * sizeof(T));
+
+    auto const num_hashes = bytes_per_size / sizeof(T);
+
+    uint64_t sink = 0;
+    auto const c = ct::current_cycles();
+    for (auto i = 0u; i < num_hashes; ++i)
+        sink += cc::make_hash(structs[i % num_structs]);
+    auto const cycles = ct::current_cycles() - c;
+    ct::sink << sink;
+
+    std::cout << name << " (" << sizeof(T) << " bytes): " << double(cycles) / double(num_hashes * sizeof(T)) << " cycles / byte, "
+              << double(cycles) / double(num_hashes) << " cycles / hash" << std::endl;
+}
+
+// number of keys in the fullest of 2^bits buckets relative to the expected load, 1.0 is perfect
+template <class Key, class F>
+double max_bucket_load(std::vector<Key> const& keys, unsigned bits, F&& hash_fun)
+{
+    std::vector<unsigned> buckets(size_t(1) << bits, 0u);
+    unsigned max_load = 0;
+    for (auto const& k : keys)
+    {
+        auto& b = buckets[hash_fun(k) & ((uint64_t(1) << bits) - 1)];
+        ++b;
+        max_load = b > max_load ? b : max_load;
+    }
+    return double(max_load) / (double(keys.size()) / double(buckets.size()));
+}
+
+// average fraction of output bits that flip when a single input bit flips, 0.5 is ideal
+template <class F>
+double avalanche(F&& hash_fun)
+{
+    auto constexpr num_inputs = 10'000u;
+
+    uint64_t num_flipped = 0;
+    uint64_t state = 0x2545F4914F6CDD1Dull;
+    for (auto i = 0u; i < num_inputs; ++i)
+    {
+        // xorshift64
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+
+        auto const h = uint64_t(hash_fun(state));
+        for (auto bit = 0; bit < 64; ++bit)
+        {
+            auto const diff = h ^ uint64_t(hash_fun(state ^ (uint64_t(1) << bit)));
+            for (auto d = diff; d != 0; d &= d - 1)
+                ++num_flipped;
+        }
+    }
+    return double(num_flipped) / (double(num_inputs) * 64.0 * 64.0);
+}
+}
+
+TEST("cc::hash benchmark")
+{
+#if !DO_BENCHMARK
+    CHECK(true);
+    return;
+#endif
+
+    // throughput on byte blobs
+    {
+        std::vector<std::byte> data(bytes_per_size / 16 + 64 * 1024);
+        for (auto i = 0u; i < data.size(); ++i)
+            data[i] = std::byte((i * 7919) >> 3);
+
+        for (auto size : blob_sizes)
+        {
+            measure_throughput("cc::hash_combine of 8 byte words", size, data, hash_blob_words);
+            measure_content_throughput("cc::make_hash(cc::string_view)", size, data, [](std::byte const* d, size_t s) {
+                return cc::make_hash(cc::string_view(reinterpret_cast<char const*>(d), s));
+            });
+            measure_span_throughput<cc::span<std::byte const>>("cc::make_hash(cc::span<std::byte const>)", size, data);
+            measure_throughput("std::hash<std::string_view>", size, data, [](std::byte const* d, size_t s) {
+                return std::hash<std::string_view>{}(std::string_view(reinterpret_cast<char const*>(d), s));
+            });
+        }
+
+        measure_struct_throughput<trivial_16>("cc::make_hash(trivial struct)", data);
+        measure_struct_throughput<trivial_64>("cc::make_hash(trivial struct)", data);
+    }
+
+    // throughput on strings
+    {
+        for (auto size : blob_sizes)
+        {
+            cc::string s;
+            s.resize(size, 'x');
+
+            auto const num_hashes = bytes_per_size / size;
+            uint64_t sink = 0;
+            auto const c = ct::current_cycles();
+            for (auto i = 0u; i < num_hashes; ++i)
+            {
+                s[i % size] = char('a' + i % 26);
+                sink += cc::make_hash(s);
+            }
+            auto const cycles = ct::current_cycles() - c;
+            ct::sink << sink;
+
+            std::cout << "cc::make_hash(cc::string) (" << size << " bytes): " << double(cycles) / double(num_hashes * size) << " cycles / byte"
+                      << std::endl;
+        }
+    }
+
+    // quality
+    {
+        auto constexpr num_keys = 1'000'000u;
+        auto constexpr bucket_bits = 16u;
+
+        std::vector<cc::string> string_keys;
+        std::vector<uint64_t> int_keys;
+        string_keys.reserve(num_keys);
+        int_keys.reserve(num_keys);
+        for (auto i = 0u; i < num_keys; ++i)
+        {
+            string_keys.push_back(cc::to_string(i));
+            // sequential keys with stride, a common pattern for handles and indices
+            int_keys.push_back(uint64_t(i) << 8);
+        }
+
+        std::cout << "cc::make_hash(cc::string) sequential numbers: max bucket load "
+                  << max_bucket_load(string_keys, bucket_bits, [](cc::string const& k) { return cc::make_hash(k); }) << "x expected" << std::endl;
+        std::cout << "cc::make_hash(uint64_t) strided keys: max bucket load "
+                  << max_bucket_load(int_keys, bucket_bits, [](uint64_t k) { return cc::make_hash(k); }) << "x expected" << std::endl;
+        std::cout << "cc::make_hash(uint64_t) avalanche: " << avalanche([](uint64_t k) { return cc::make_hash(k); }) << " (0.5 is ideal)"
+                  << std::endl;
+    }
+}
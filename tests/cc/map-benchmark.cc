@@ -0,0 +1,174 @@
+#include <nexus/test.hh>
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <ctracer/benchmark.hh>
+
+#include <clean-core/map.hh>
+#include <clean-core/string.hh>
+#include <clean-core/to_string.hh>
+
+#define DO_BENCHMARK 0
+
+namespace
+{
+size_t const sizes[] = {1'000, 10'000, 100'000, 1'000'000, 10'000'000};
+
+// scrambled but unique keys (multiplication by an odd constant is a bijection)
+// so neither insertion nor lookup order is sequential
+uint64_t scramble(uint64_t i) { return i * 0x9E3779B97F4A7C15ull; }
+
+template <class Key>
+Key make_key(uint64_t i);
+template <>
+int make_key<int>(uint64_t i)
+{
+    return int(uint32_t(i) * 2654435761u);
+}
+template <>
+cc::string make_key<cc::string>(uint64_t i)
+{
+    return cc::to_string(scramble(i));
+}
+template <>
+std::string make_key<std::string>(uint64_t i)
+{
+    return std::to_string(scramble(i));
+}
+
+template <class K, class V>
+bool has_key(cc::map<K, V> const& m, K const& k)
+{
+    return m.contains_key(k);
+}
+template <class K, class V>
+bool has_key(std::unordered_map<K, V> const& m, K const& k)
+{
+    return m.count(k) > 0;
+}
+
+template <class Map, class Key>
+void measure(char const* name, size_t size)
+{
+    std::vector<Key> keys;
+    std::vector<Key> lookup_keys;
+    std::vector<Key> missing_keys;
+    keys.reserve(size);
+    lookup_keys.reserve(size);
+    missing_keys.reserve(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        keys.push_back(make_key<Key>(i));
+        missing_keys.push_back(make_key<Key>(i + size));
+    }
+    for (size_t i = 0; i < size; ++i)
+        lookup_keys.push_back(keys[(i * 7919) % size]);
+
+    Map m;
+
+    auto c = ct::current_cycles();
+    for (size_t i = 0; i < size; ++i)
+        m[keys[i]] = int(i);
+    auto const cycles_insert = (ct::current_cycles() - c) / size;
+
+    auto found = 0;
+    c = ct::current_cycles();
+    for (auto const& k : lookup_keys)
+        found += has_key(m, k);
+    auto const cycles_hit = (ct::current_cycles() - c) / size;
+    CHECK(found == int(size));
+
+    found = 0;
+    c = ct::current_cycles();
+    for (auto const& k : missing_keys)
+        found += has_key(m, k);
+    auto const cycles_miss = (ct::current_cycles() - c) / size;
+    ct::sink << found;
+
+    std::cout << name << " (" << size << "): insert " << cycles_insert << ", hit " << cycles_hit << ", miss " << cycles_miss << " cycles / op"
+              << std::endl;
+}
+
+// read-heavy lookups into a shared cc::map from several threads, the way caches shared across td workers work today
+template <class Mutex, class ReadLock>
+void measure_shared_reads(char const* name, unsigned num_threads)
+{
+    auto constexpr size = 100'000u;
+    auto constexpr num_lookups_per_thread = 1'000'000u;
+
+    cc::map<int, int> m;
+    for (auto i = 0u; i < size; ++i)
+        m[make_key<int>(i)] = int(i);
+
+    Mutex mutex;
+    std::atomic_int num_found = {0};
+
+    auto const t0 = std::chrono::high_resolution_clock::now();
+
+    std::vector<std::thread> threads;
+    for (auto t = 0u; t < num_threads; ++t)
+    {
+        threads.emplace_back([&m, &mutex, &num_found, t] {
+            auto found = 0;
+            for (auto i = 0u; i < num_lookups_per_thread; ++i)
+            {
+                ReadLock lock(mutex);
+                found += m.contains_key(make_key<int>((i * 7919 + t) % size));
+            }
+            num_found += found;
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    auto const seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - t0).count();
+
+    CHECK(num_found.load() == int(num_threads * num_lookups_per_thread));
+
+    std::cout << name << " (" << num_threads << " threads): " << double(num_threads) * num_lookups_per_thread / seconds / 1e6 << " M lookups / s"
+              << std::endl;
+}
+}
+
+TEST("cc::map benchmark")
+{
+#if !DO_BENCHMARK
+    CHECK(true);
+    return;
+#endif
+
+    for (auto size : sizes)
+    {
+        measure<cc::map<int, int>, int>("cc::map<int, int>", size);
+        measure<std::unordered_map<int, int>, int>("std::unordered_map<int, int>", size);
+        measure<cc::map<cc::string, int>, cc::string>("cc::map<cc::string, int>", size);
+        measure<std::unordered_map<std::string, int>, std::string>("std::unordered_map<std::string, int>", size);
+    }
+}
+
+TEST("cc::map shared read benchmark")
+{
+#if !DO_BENCHMARK
+    CHECK(true);
+    return;
+#endif
+
+    // powers of two, always including the full core count
+    auto const max_threads = std::thread::hardware_concurrency() > 0 ? std::thread::hardware_concurrency() : 1u;
+    for (auto num_threads = 1u;; num_threads = num_threads * 2 < max_threads ? num_threads * 2 : max_threads)
+    {
+        measure_shared_reads<std::mutex, std::lock_guard<std::mutex>>("cc::map + std::mutex", num_threads);
+        measure_shared_reads<std::shared_mutex, std::shared_lock<std::shared_mutex>>("cc::map + std::shared_mutex", num_threads);
+
+        if (num_threads >= max_threads)
+            break;
+    }
+}
@@ -0,0 +1,95 @@
+#include <nexus/test.hh>
+
+#include <iostream>
+
+#include <ctracer/benchmark.hh>
+
+#include <clean-core/string.hh>
+#include <clean-core/unique_ptr.hh>
+#include <clean-core/vector.hh>
+
+#define DO_BENCHMARK 0
+
+namespace
+{
+// growth without reserve, every reallocation relocates all elements
+auto constexpr num_push_backs = 1'000'000u;
+
+// removal from the front, every remove relocates the rest of the vector
+auto constexpr num_removes = 10'000u;
+
+template <class T>
+T make_element(unsigned i);
+template <>
+int make_element<int>(unsigned i)
+{
+    return int(i);
+}
+template <>
+cc::string make_element<cc::string>(unsigned)
+{
+    // long enough to not fit into the small string buffer
+    return cc::string("a string that is stored on the heap");
+}
+template <>
+cc::unique_ptr<int> make_element<cc::unique_ptr<int>>(unsigned i)
+{
+    return cc::make_unique<int>(int(i));
+}
+template <>
+cc::vector<int> make_element<cc::vector<int>>(unsigned i)
+{
+    return cc::vector<int>{int(i), int(i), int(i)};
+}
+
+template <class T>
+void measure(char const* name)
+{
+    // elements are created up front so only the vector operations are measured
+    cc::vector<T> elements;
+    elements.reserve(num_push_backs);
+    for (auto i = 0u; i < num_push_backs; ++i)
+        elements.push_back(make_element<T>(i));
+
+    uint64_t cycles_push_back = 0;
+    {
+        cc::vector<T> v;
+        auto const c = ct::current_cycles();
+        for (auto& e : elements)
+            v.push_back(cc::move(e));
+        cycles_push_back = (ct::current_cycles() - c) / num_push_backs;
+        ct::sink << v.data();
+    }
+
+    uint64_t cycles_remove = 0;
+    {
+        cc::vector<T> v;
+        v.reserve(num_removes);
+        for (auto i = 0u; i < num_removes; ++i)
+            v.push_back(make_element<T>(i));
+
+        auto const c = ct::current_cycles();
+        for (auto i = 0u; i < num_removes; ++i)
+            v.remove_at(0);
+        cycles_remove = (ct::current_cycles() - c) / num_removes;
+        CHECK(v.empty());
+    }
+
+    std::cout << name << ": push_back (growing) " << cycles_push_back << ", remove_at(0) of " << num_removes << " " << cycles_remove
+              << " cycles / op" << std::endl;
+}
+}
+
+TEST("cc::vector relocation benchmark")
+{
+#if !DO_BENCHMARK
+    CHECK(true);
+    return;
+#endif
+
+    // int is the memcpy baseline, the other types are relocated by move + destroy
+    measure<int>("cc::vector<int>");
+    measure<cc::string>("cc::vector<cc::string>");
+    measure<cc::unique_ptr<int>>("cc::vector<cc::unique_ptr<int>>");
+    measure<cc::vector<int>>("cc::vector<cc::vector<int>>");
+}
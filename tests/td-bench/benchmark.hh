@@ -0,0 +1,111 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <clean-core/macros.hh>
+
+#include <task-dispatcher/common/math_intrin.hh>
+
+#ifdef CC_OS_LINUX
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+// shared helpers for the td benchmarks
+// all timings are wall-clock, the best of several runs is reported to filter out scheduling noise
+
+inline void spin_cycles(uint64_t cycles)
+{
+    auto const current = td::intrin::rdtsc();
+    while (td::intrin::rdtsc() - current < cycles)
+    {
+        _mm_pause();
+    }
+}
+
+// returns the best wall time of f() over num_runs runs, in seconds
+template <class F>
+double measure_seconds(int num_runs, F&& f)
+{
+    double best = 1e300;
+    for (auto i = 0; i < num_runs; ++i)
+    {
+        auto const t0 = std::chrono::high_resolution_clock::now();
+        f();
+        auto const t1 = std::chrono::high_resolution_clock::now();
+
+        auto const seconds = std::chrono::duration<double>(t1 - t0).count();
+        if (seconds < best)
+            best = seconds;
+    }
+    return best;
+}
+
+// returns the p-th percentile (p in [0, 1]) of the samples, sorts them in the process
+inline double percentile(std::vector<double>& samples, double p)
+{
+    if (samples.empty())
+        return 0.0;
+
+    std::sort(samples.begin(), samples.end());
+    auto const index = size_t(p * double(samples.size() - 1) + 0.5);
+    return samples[index];
+}
+
+// true if resident_memory_bytes() returns actual measurements on this platform
+// results depending on it must not be reported otherwise
+#ifdef CC_OS_LINUX
+inline bool constexpr can_measure_resident_memory = true;
+#else
+inline bool constexpr can_measure_resident_memory = false;
+#endif
+
+// current resident set size of the process in bytes, 0 if unsupported on this platform
+inline size_t resident_memory_bytes()
+{
+#ifdef CC_OS_LINUX
+    size_t num_pages_total = 0;
+    size_t num_pages_resident = 0;
+    std::ifstream statm("/proc/self/statm");
+    statm >> num_pages_total >> num_pages_resident;
+    return num_pages_resident * size_t(sysconf(_SC_PAGESIZE));
+#else
+    return 0;
+#endif
+}
+
+// true if process_cpu_seconds() returns actual measurements on this platform
+// results depending on it must not be reported otherwise
+#ifdef CC_OS_LINUX
+inline bool constexpr can_measure_cpu_time = true;
+#else
+inline bool constexpr can_measure_cpu_time = false;
+#endif
+
+// user + system CPU time consumed by all threads of the process so far in seconds, 0 if unsupported on this platform
+inline double process_cpu_seconds()
+{
+#ifdef CC_OS_LINUX
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return double(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) + double(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1e-6;
+#else
+    return 0.0;
+#endif
+}
+
+// prints a single result as one JSON object per line, e.g.
+//   {"benchmark": "td submit", "variant": "empty task", "threads": 16, "value": 85.2, "unit": "ns / task"}
+// so runs can be collected with 'grep "^{"' and compared across scheduler changes
+// names must not contain quotes or backslashes
+inline void report(std::string const& benchmark, std::string const& variant, unsigned num_threads, double value, char const* unit)
+{
+    std::cout << "{\"benchmark\": \"" << benchmark << "\", \"variant\": \"" << variant << "\", \"threads\": " << num_threads //
+              << ", \"value\": " << value << ", \"unit\": \"" << unit << "\"}" << std::endl;
+}
@@ -0,0 +1,147 @@
+#include <nexus/test.hh>
+
+#include <atomic>
+
+#include <task-dispatcher/common/system_info.hh>
+#include <task-dispatcher/native/fiber.hh>
+#include <task-dispatcher/td.hh>
+
+#include "benchmark.hh"
+
+// core td costs, meant to be tracked across scheduler changes
+// wake-up latency is covered by the idle benchmark
+
+namespace
+{
+auto constexpr num_runs = 5;
+
+// submit
+auto constexpr num_tasks_per_wave = 512u;
+auto constexpr num_waves = 500u;
+
+// nested wait
+auto constexpr num_waiting_tasks = 64u;
+auto constexpr num_waits_per_task = 200u;
+
+// fiber switch
+auto constexpr kHalfMebibyte = 524288;
+auto constexpr num_fiber_roundtrips = 1000000u;
+
+// fan-out
+unsigned const fan_out_sizes[] = {1000u, 100000u, 10000000u};
+
+// a task takes about 64 bytes, larger fan-outs are submitted in waves instead of raising the task capacity further
+auto constexpr max_fan_out_task_capacity = 1u << 20;
+
+struct pingpong_arg
+{
+    td::native::fiber_t main_fiber;
+    td::native::fiber_t other_fiber;
+};
+
+void pingpong_fiber_func(void* arg)
+{
+    auto* const fibers = static_cast<pingpong_arg*>(arg);
+    while (true)
+        td::native::switch_to_fiber(fibers->main_fiber, fibers->other_fiber);
+}
+}
+
+TEST("td core (submit, nested wait, fiber switch, fan-out)", exclusive)
+{
+    auto const num_threads = unsigned(td::system::num_logical_cores());
+
+    // fiber switch, no scheduler involved
+    {
+        pingpong_arg fibers;
+        td::native::create_main_fiber(fibers.main_fiber);
+        td::native::create_fiber(fibers.other_fiber, pingpong_fiber_func, &fibers, kHalfMebibyte);
+
+        auto const t = measure_seconds(num_runs, [&] {
+            for (auto _ = 0u; _ < num_fiber_roundtrips; ++_)
+                td::native::switch_to_fiber(fibers.other_fiber, fibers.main_fiber);
+        });
+
+        td::native::delete_fiber(fibers.other_fiber);
+        td::native::delete_main_fiber(fibers.main_fiber);
+
+        report("td fiber switch", "native ping-pong", 1, t * 1e9 / (2.0 * num_fiber_roundtrips), "ns / switch");
+    }
+
+    td::launch([&] {
+        // empty task submit throughput, one td::submit call per task
+        {
+            auto const t = measure_seconds(num_runs, [] {
+                for (auto _ = 0u; _ < num_waves; ++_)
+                {
+                    td::sync s;
+                    for (auto i = 0u; i < num_tasks_per_wave; ++i)
+                        td::submit(s, [] {});
+                    td::wait_for(s);
+                }
+            });
+
+            auto const num_tasks = double(num_waves * num_tasks_per_wave);
+            report("td submit", "empty task", num_threads, t * 1e9 / num_tasks, "ns / task");
+            report("td submit throughput", "empty task", num_threads, num_tasks / t / 1e6, "M tasks / s");
+        }
+
+        // nested wait: a task waits on a single empty child, parking and resuming its fiber
+        {
+            std::atomic_int num_waits = {0};
+
+            auto const t = measure_seconds(num_runs, [&num_waits] {
+                auto s = td::submit_n(
+                    [&num_waits](auto) {
+                        for (auto _ = 0u; _ < num_waits_per_task; ++_)
+                        {
+                            auto s_child = td::submit([] {});
+                            td::wait_for(s_child);
+                            ++num_waits;
+                        }
+                    },
+                    num_waiting_tasks);
+                td::wait_for(s);
+            });
+
+            CHECK(num_waits.load() == int(num_runs * num_waiting_tasks * num_waits_per_task));
+
+            report("td nested wait", "single empty child", num_threads, t * 1e9 / double(num_waiting_tasks * num_waits_per_task), "ns / wait");
+        }
+    });
+
+    // submit_n fan-out, every size gets a scheduler with enough task capacity for a single submit_n
+    // sizes that would exceed max_fan_out_task_capacity are submitted in waves of half that capacity
+    for (auto const num_tasks : fan_out_sizes)
+    {
+        auto task_capacity = 1u;
+        while (task_capacity <= num_tasks + 1)
+            task_capacity *= 2;
+        task_capacity = task_capacity < max_fan_out_task_capacity ? task_capacity : max_fan_out_task_capacity;
+
+        auto const max_wave_size = num_tasks + 1 < task_capacity ? num_tasks : task_capacity / 2;
+
+        td::scheduler_config config;
+        config.max_num_tasks = task_capacity;
+
+        td::launch(config, [&] {
+            std::atomic_int counter = {0};
+
+            auto const t = measure_seconds(num_runs, [&] {
+                for (auto submitted = 0u; submitted < num_tasks; submitted += max_wave_size)
+                {
+                    auto const wave_size = num_tasks - submitted < max_wave_size ? num_tasks - submitted : max_wave_size;
+                    auto s = td::submit_n([&counter](auto) { ++counter; }, wave_size);
+                    td::wait_for(s);
+                }
+            });
+
+            CHECK(counter.load() == int(num_runs * num_tasks));
+
+            auto variant = std::to_string(num_tasks) + " tasks";
+            if (max_wave_size < num_tasks)
+                variant += " (waves of " + std::to_string(max_wave_size) + ")";
+            report("td submit_n fan-out", variant, num_threads, t * 1e9 / double(num_tasks), "ns / task");
+        });
+    }
+}
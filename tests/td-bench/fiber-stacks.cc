@@ -0,0 +1,116 @@
+#include <nexus/test.hh>
+
+#include <memory>
+
+#include <task-dispatcher/common/system_info.hh>
+#include <task-dispatcher/native/fiber.hh>
+#include <task-dispatcher/td.hh>
+
+#include "benchmark.hh"
+
+namespace
+{
+// same stack size as the td::native::fiber tests
+auto constexpr kHalfMebibyte = 524288;
+
+unsigned const num_fibers_variants[] = {256u, 1024u, 4096u};
+
+auto constexpr num_runs = 5;
+
+struct fiber_arg
+{
+    td::native::fiber_t* main_fiber = nullptr;
+    td::native::fiber_t* self = nullptr;
+};
+
+void touching_fiber_func(void* arg)
+{
+    auto* const self_arg = static_cast<fiber_arg*>(arg);
+
+    // touch a few pages of the stack, like a shallow task would
+    volatile char stack_data[16 * 1024];
+    for (auto i = 0u; i < sizeof(stack_data); i += 1024)
+        stack_data[i] = char(i);
+
+    td::native::switch_to_fiber(*self_arg->main_fiber, *self_arg->self);
+
+    // We should never get here
+    CHECK(false);
+}
+
+double delta_mib(size_t bytes_after, size_t bytes_before) { return (double(bytes_after) - double(bytes_before)) / (1024.0 * 1024.0); }
+}
+
+TEST("td::native::fiber stacks (creation time and RSS)", exclusive)
+{
+    for (auto const num_fibers : num_fibers_variants)
+    {
+        td::native::fiber_t main_fiber;
+        td::native::create_main_fiber(main_fiber);
+
+        auto fibers = std::make_unique<td::native::fiber_t[]>(num_fibers);
+        auto args = std::make_unique<fiber_arg[]>(num_fibers);
+
+        auto const rss_before = resident_memory_bytes();
+
+        auto const t0 = std::chrono::high_resolution_clock::now();
+        for (auto i = 0u; i < num_fibers; ++i)
+        {
+            args[i] = {&main_fiber, &fibers[i]};
+            td::native::create_fiber(fibers[i], touching_fiber_func, &args[i], kHalfMebibyte);
+        }
+        auto const t1 = std::chrono::high_resolution_clock::now();
+
+        auto const rss_created = resident_memory_bytes();
+
+        // run every fiber once so it touches its stack
+        for (auto i = 0u; i < num_fibers; ++i)
+            td::native::switch_to_fiber(fibers[i], main_fiber);
+
+        auto const rss_touched = resident_memory_bytes();
+
+        auto const t2 = std::chrono::high_resolution_clock::now();
+        for (auto i = 0u; i < num_fibers; ++i)
+            td::native::delete_fiber(fibers[i]);
+        auto const t3 = std::chrono::high_resolution_clock::now();
+
+        td::native::delete_main_fiber(main_fiber);
+
+        auto const create_us = std::chrono::duration<double>(t1 - t0).count() * 1e6 / num_fibers;
+        auto const delete_us = std::chrono::duration<double>(t3 - t2).count() * 1e6 / num_fibers;
+
+        auto const variant = std::to_string(num_fibers) + " fibers";
+        report("td fiber stacks create", variant, 1, create_us, "us / fiber");
+        report("td fiber stacks delete", variant, 1, delete_us, "us / fiber");
+        if (can_measure_resident_memory)
+        {
+            report("td fiber stacks RSS after create", variant, 1, delta_mib(rss_created, rss_before), "MiB");
+            report("td fiber stacks RSS after touch", variant, 1, delta_mib(rss_touched, rss_before), "MiB");
+        }
+    }
+}
+
+TEST("td scheduler startup (time and RSS)", exclusive)
+{
+    auto const num_threads = unsigned(td::system::num_logical_cores());
+
+    auto const rss_before = resident_memory_bytes();
+    size_t rss_running = 0;
+
+    // launch to first task, includes thread, fiber and stack creation
+    std::chrono::high_resolution_clock::time_point t_first_task;
+    auto const t0 = std::chrono::high_resolution_clock::now();
+    td::launch([&] {
+        t_first_task = std::chrono::high_resolution_clock::now();
+        rss_running = resident_memory_bytes();
+    });
+    auto const t1 = std::chrono::high_resolution_clock::now();
+
+    auto const t_roundtrip = measure_seconds(num_runs, [] { td::launch([] {}); });
+
+    report("td scheduler startup", "launch to first task", num_threads, std::chrono::duration<double>(t_first_task - t0).count() * 1000.0, "ms");
+    report("td scheduler startup", "launch and shutdown", num_threads, std::chrono::duration<double>(t1 - t0).count() * 1000.0, "ms");
+    report("td scheduler startup", "launch and shutdown (warm)", num_threads, t_roundtrip * 1000.0, "ms");
+    if (can_measure_resident_memory)
+        report("td scheduler startup", "RSS while running", num_threads, delta_mib(rss_running, rss_before), "MiB");
+}
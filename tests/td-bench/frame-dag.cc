@@ -0,0 +1,72 @@
+#include <nexus/test.hh>
+
+#include <atomic>
+
+#include <clean-core/array.hh>
+
+#include <task-dispatcher/common/system_info.hh>
+#include <task-dispatcher/scheduler.hh>
+#include <task-dispatcher/td.hh>
+
+#include "benchmark.hh"
+
+using namespace td;
+
+namespace
+{
+// a layered per-frame DAG: all nodes of a layer depend on all nodes of the previous layer
+// the critical path is num_layers nodes long
+auto constexpr num_layers = 6u;
+auto constexpr nodes_per_layer = 16u;
+
+auto constexpr num_frames = 2000;
+auto constexpr num_runs = 3;
+
+// executes one frame, rebuilding tasks and counters from scratch
+// this is the acquireCounterHandle/submitTasks/releaseCounter churn a prebuilt graph avoids
+void run_frame(std::atomic_int& counter, uint64_t node_cycles)
+{
+    auto& sched = Scheduler::Current();
+
+    for (auto layer = 0u; layer < num_layers; ++layer)
+    {
+        cc::array<container::task, nodes_per_layer> tasks;
+        for (container::task& task : tasks)
+        {
+            task.lambda([&counter, node_cycles] {
+                spin_cycles(node_cycles);
+                ++counter;
+            });
+        }
+
+        auto s = sched.acquireCounterHandle();
+        sched.submitTasks(tasks.data(), unsigned(tasks.size()), s);
+        sched.wait(s, true);
+        sched.releaseCounter(s);
+    }
+}
+}
+
+TEST("td per-frame DAG rebuild", exclusive)
+{
+    auto const num_threads = unsigned(td::system::num_logical_cores());
+
+    for (auto node_cycles : {0ull, 1000ull, 10000ull})
+    {
+        std::atomic_int counter = {0};
+        double time = 0.0;
+
+        td::launch([&] {
+            time = measure_seconds(num_runs, [&] {
+                for (auto _ = 0; _ < num_frames; ++_)
+                    run_frame(counter, node_cycles);
+            });
+        });
+
+        CHECK(counter.load() == int(num_runs * num_frames * num_layers * nodes_per_layer));
+
+        auto const variant
+            = std::to_string(num_layers) + "x" + std::to_string(nodes_per_layer) + " nodes, " + std::to_string(node_cycles) + " cycles per node";
+        report("td frame dag rebuild", variant, num_threads, time * 1e6 / num_frames, "us / frame");
+    }
+}
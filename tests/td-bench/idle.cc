@@ -0,0 +1,89 @@
+#include <nexus/test.hh>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <task-dispatcher/common/system_info.hh>
+#include <task-dispatcher/td.hh>
+
+#include "benchmark.hh"
+
+namespace
+{
+auto constexpr idle_measure_duration = std::chrono::milliseconds(500);
+
+// how long the workers are left idle before a task is submitted
+std::chrono::microseconds const idle_durations[] = {
+    std::chrono::microseconds(100),
+    std::chrono::microseconds(1000),
+    std::chrono::microseconds(10000),
+};
+
+auto constexpr num_wakeups = 100;
+
+using bench_clock = std::chrono::high_resolution_clock;
+
+// submits a single task after the workers had time to go idle
+// the submitting thread does not wait on the task until it started, so a worker has to pick it up
+// requires at least two worker threads, otherwise nothing can run the task and this spins forever
+double measure_wakeup_latency(std::chrono::microseconds idle_duration)
+{
+    std::this_thread::sleep_for(idle_duration);
+
+    std::atomic_bool started = {false};
+    bench_clock::time_point t_started;
+
+    auto const t_submitted = bench_clock::now();
+    auto s = td::submit([&] {
+        t_started = bench_clock::now();
+        started.store(true);
+    });
+
+    while (!started.load())
+    {
+        _mm_pause();
+    }
+
+    td::wait_for(s);
+    return std::chrono::duration<double>(t_started - t_submitted).count();
+}
+}
+
+TEST("td idle cost and wake-up latency", exclusive)
+{
+    td::scheduler_config config;
+    auto const num_threads = unsigned(config.num_threads);
+
+    td::launch(config, [&] {
+        // CPU time burned by the workers while there is nothing to do
+        // the sleeping main thread itself contributes close to nothing
+        if (can_measure_cpu_time)
+        {
+            auto const cpu_before = process_cpu_seconds();
+            auto const t0 = bench_clock::now();
+            std::this_thread::sleep_for(idle_measure_duration);
+            auto const t1 = bench_clock::now();
+            auto const cpu_after = process_cpu_seconds();
+
+            auto const wall = std::chrono::duration<double>(t1 - t0).count();
+            report("td idle", "busy cores while idle", num_threads, (cpu_after - cpu_before) / wall, "cores");
+        }
+
+        // the main task busy-waits without yielding, a second worker has to run the task
+        if (num_threads < 2)
+            return;
+
+        for (auto const idle_duration : idle_durations)
+        {
+            std::vector<double> latencies;
+            latencies.reserve(num_wakeups);
+            for (auto _ = 0; _ < num_wakeups; ++_)
+                latencies.push_back(measure_wakeup_latency(idle_duration));
+
+            auto const variant = "after " + std::to_string(idle_duration.count()) + " us idle";
+            report("td wake-up latency p50", variant, num_threads, percentile(latencies, 0.5) * 1e6, "us");
+            report("td wake-up latency p99", variant, num_threads, percentile(latencies, 0.99) * 1e6, "us");
+        }
+    });
+}
@@ -0,0 +1,93 @@
+#include <nexus/test.hh>
+
+#include <atomic>
+#include <vector>
+
+#include <task-dispatcher/common/system_info.hh>
+#include <task-dispatcher/td.hh>
+
+#include "benchmark.hh"
+
+namespace
+{
+// background work: long tasks that keep every worker busy
+auto constexpr background_task_cycles = 200000ull;
+auto constexpr background_tasks_per_core = 16u;
+
+auto constexpr num_probes = 500;
+auto constexpr probe_interval_cycles = 1000000ull;
+
+using bench_clock = std::chrono::high_resolution_clock;
+
+std::vector<double> measure_probe_latencies(bool with_background)
+{
+    std::vector<double> latencies;
+    latencies.reserve(num_probes);
+
+    auto const num_cores = unsigned(td::system::num_logical_cores());
+
+    // capped like the fan-out waves in core.cc, leaves room in the task queue for the probes
+    auto const max_wave_size = unsigned(td::scheduler_config{}.max_num_tasks) / 2;
+    auto const wave_size = num_cores * background_tasks_per_core < max_wave_size ? num_cores * background_tasks_per_core : max_wave_size;
+
+    std::atomic_bool stop = {false};
+    std::atomic_int num_background_tasks = {0};
+
+    // keeps the scheduler saturated until the probes are done
+    td::sync s_background;
+    if (with_background)
+    {
+        td::submit(s_background, [&stop, &num_background_tasks, wave_size] {
+            while (!stop.load())
+            {
+                auto s = td::submit_n(
+                    [&num_background_tasks](auto) {
+                        spin_cycles(background_task_cycles);
+                        ++num_background_tasks;
+                    },
+                    wave_size);
+                td::wait_for(s);
+            }
+        });
+    }
+
+    for (auto _ = 0; _ < num_probes; ++_)
+    {
+        spin_cycles(probe_interval_cycles);
+
+        bench_clock::time_point t_started;
+        auto const t_submitted = bench_clock::now();
+        auto s = td::submit([&t_started] { t_started = bench_clock::now(); });
+        td::wait_for(s);
+
+        latencies.push_back(std::chrono::duration<double>(t_started - t_submitted).count());
+    }
+
+    stop.store(true);
+
+    if (with_background)
+    {
+        td::wait_for(s_background);
+        CHECK(num_background_tasks.load() > 0);
+    }
+
+    return latencies;
+}
+}
+
+TEST("td task latency under background load", exclusive)
+{
+    auto const num_threads = unsigned(td::system::num_logical_cores());
+
+    td::launch([&] {
+        for (auto const with_background : {false, true})
+        {
+            auto latencies = measure_probe_latencies(with_background);
+
+            auto const variant = with_background ? "saturated" : "idle";
+            report("td latency under load p50", variant, num_threads, percentile(latencies, 0.5) * 1e6, "us");
+            report("td latency under load p99", variant, num_threads, percentile(latencies, 0.99) * 1e6, "us");
+            report("td latency under load max", variant, num_threads, percentile(latencies, 1.0) * 1e6, "us");
+        }
+    });
+}
@@ -0,0 +1,146 @@
+#include <nexus/test.hh>
+
+#include <vector>
+
+#include <task-dispatcher/common/system_info.hh>
+#include <task-dispatcher/td.hh>
+
+#include "benchmark.hh"
+
+namespace
+{
+// same workload as the td::Scheduler (dependency) test
+auto constexpr workload_size = 5000000u;
+
+// a few hand-picked chunk sizes to compare against
+unsigned const fixed_chunk_sizes[] = {1000u, 10000u, 100000u};
+
+// in the skewed workload, the cost of an element grows with its index
+auto constexpr skewed_workload_size = 20000u;
+auto constexpr skewed_max_cycles = 4000ull;
+
+auto constexpr num_runs = 5;
+
+// hand-picked number of leaf ranges per worker thread for the eager recursive split
+auto constexpr split_ranges_per_thread = 8u;
+
+// eager recursive split over [begin, end)
+// the upper half of a range is handed to the scheduler, the lower half is split further on the current worker until it is below the grain
+// this always splits down to the grain, no matter whether other workers are idle, so it is NOT an auto-partitioner:
+// it is fixed chunking with chunk = ceil(size / num_ranges), reached through recursion
+// halving with that grain yields exactly num_ranges leaves if num_ranges is a power of two and much smaller than the range
+// every split_range call holds a td::sync and parks a fiber while it waits, one per leaf range
+template <class F>
+void split_range(unsigned begin, unsigned end, unsigned grain, F const& f)
+{
+    td::sync s;
+    while (end - begin > grain)
+    {
+        auto const mid = begin + (end - begin) / 2;
+        td::submit(s, [mid, end, grain, &f] { split_range(mid, end, grain, f); });
+        end = mid;
+    }
+
+    f(begin, end);
+    td::wait_for(s);
+}
+
+template <class F>
+void parallel_for_eager_split(unsigned begin, unsigned end, unsigned num_ranges, F const& f)
+{
+    auto const grain = (end - begin + num_ranges - 1) / num_ranges;
+    split_range(begin, end, grain, f);
+}
+
+// chunks are submitted in waves of at most max_wave_size tasks to stay below scheduler_config::max_num_tasks
+template <class F>
+void parallel_for_fixed(unsigned size, unsigned chunk_size, unsigned max_wave_size, F const& f)
+{
+    auto const num_chunks = (size + chunk_size - 1) / chunk_size;
+    for (auto wave_start = 0u; wave_start < num_chunks; wave_start += max_wave_size)
+    {
+        auto const wave_size = num_chunks - wave_start < max_wave_size ? num_chunks - wave_start : max_wave_size;
+        auto s = td::submit_n(
+            [&f, size, chunk_size, wave_start](auto i) {
+                auto const chunk_start = (wave_start + unsigned(i)) * chunk_size;
+                auto const chunk_end = chunk_start + chunk_size < size ? chunk_start + chunk_size : size;
+                f(chunk_start, chunk_end);
+            },
+            wave_size);
+        td::wait_for(s);
+    }
+}
+
+void run_variants(char const* name, unsigned num_threads, unsigned size, void (*body)(unsigned, unsigned))
+{
+    td::scheduler_config config;
+    config.num_threads = num_threads;
+
+    td::launch(config, [&] {
+        for (auto chunk_size : fixed_chunk_sizes)
+        {
+            if (chunk_size > size)
+                continue;
+
+            auto const max_wave_size = unsigned(config.max_num_tasks) / 2;
+            auto const t = measure_seconds(num_runs, [&] { parallel_for_fixed(size, chunk_size, max_wave_size, body); });
+            report(name, "fixed chunks of " + std::to_string(chunk_size), num_threads, t * 1000.0, "ms");
+        }
+
+        // sized for the active thread count, capped so the parked splits stay well below the fiber and counter limits
+        // every worker needs a running fiber on top of the parked ones
+        auto const num_fibers = unsigned(config.num_fibers);
+        auto const max_num_ranges_fibers = num_fibers > num_threads ? (num_fibers - num_threads) / 2 : 1u;
+        auto max_num_ranges = split_ranges_per_thread * num_threads;
+        max_num_ranges = max_num_ranges < max_num_ranges_fibers ? max_num_ranges : max_num_ranges_fibers;
+        max_num_ranges = max_num_ranges < unsigned(config.max_num_counters) / 2 ? max_num_ranges : unsigned(config.max_num_counters) / 2;
+
+        // rounded down to a power of two so the split produces exactly num_ranges leaves
+        auto num_ranges = 1u;
+        while (num_ranges * 2 <= max_num_ranges)
+            num_ranges *= 2;
+
+        auto const t_split = measure_seconds(num_runs, [&] { parallel_for_eager_split(0, size, num_ranges, body); });
+        report(name, "eager recursive split into " + std::to_string(num_ranges) + " ranges", num_threads, t_split * 1000.0, "ms");
+    });
+}
+
+std::vector<int> g_data;
+
+void uniform_body(unsigned begin, unsigned end)
+{
+    for (auto i = begin; i < end; ++i)
+        g_data[i] = int(i);
+}
+
+void skewed_body(unsigned begin, unsigned end)
+{
+    for (auto i = begin; i < end; ++i)
+        spin_cycles(skewed_max_cycles * i / skewed_workload_size);
+}
+}
+
+TEST("td parallel_for (fixed chunks vs. eager recursive split)", exclusive)
+{
+    auto const max_threads = unsigned(td::system::num_logical_cores());
+
+    g_data.resize(workload_size, 0);
+
+    // powers of two, always including the full core count
+    for (auto num_threads = 1u;; num_threads = num_threads * 2 < max_threads ? num_threads * 2 : max_threads)
+    {
+        run_variants("td parallel_for uniform", num_threads, workload_size, uniform_body);
+        run_variants("td parallel_for skewed", num_threads, skewed_workload_size, skewed_body);
+
+        if (num_threads >= max_threads)
+            break;
+    }
+
+    bool equal = true;
+    for (auto i = 0u; i < workload_size; ++i)
+        equal = equal && g_data[i] == int(i);
+
+    CHECK(equal);
+
+    g_data = {};
+}
@@ -0,0 +1,136 @@
+#include <nexus/test.hh>
+
+#include <cstdint>
+#include <vector>
+
+#include <task-dispatcher/common/system_info.hh>
+#include <task-dispatcher/td.hh>
+
+#include "benchmark.hh"
+
+namespace
+{
+// read chunk -> decompress -> parse -> transform -> write, with a bounded number of chunks in flight
+auto constexpr chunk_size = 64u * 1024u;
+auto constexpr num_chunks = 2000u;
+auto constexpr parallel_stage_cycles = 100000ull;
+
+auto constexpr num_runs = 3;
+
+struct chunk
+{
+    std::vector<uint32_t> data;
+    uint64_t checksum = 0;
+};
+
+// serial: has to run in stream order
+void stage_read(chunk& c, uint32_t& state)
+{
+    c.data.resize(chunk_size / sizeof(uint32_t));
+    for (auto& v : c.data)
+    {
+        // xorshift32
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        v = state;
+    }
+}
+
+// parallel: decompress, parse and transform collapsed into a single task
+void stage_process(chunk& c)
+{
+    spin_cycles(parallel_stage_cycles);
+
+    uint64_t checksum = 0;
+    for (auto v : c.data)
+        checksum = checksum * 31 + v;
+    c.checksum = checksum;
+}
+
+// serial: has to run in stream order
+void stage_write(chunk const& c, uint64_t& total) { total = total * 17 + c.checksum; }
+
+uint64_t run_serial()
+{
+    uint32_t state = 1;
+    uint64_t total = 0;
+
+    chunk c;
+    for (auto i = 0u; i < num_chunks; ++i)
+    {
+        stage_read(c, state);
+        stage_process(c);
+        stage_write(c, total);
+    }
+    return total;
+}
+
+// the hand-chained version: one td::sync per token, the main task runs the serial stages
+uint64_t run_chained(unsigned num_tokens)
+{
+    uint32_t state = 1;
+    uint64_t total = 0;
+
+    std::vector<chunk> chunks(num_tokens);
+    std::vector<td::sync> syncs(num_tokens);
+
+    for (auto i = 0u; i < num_chunks; ++i)
+    {
+        auto const slot = i % num_tokens;
+
+        // the token is still in flight with chunk i - num_tokens, retire it first
+        if (i >= num_tokens)
+        {
+            td::wait_for(syncs[slot]);
+            stage_write(chunks[slot], total);
+        }
+
+        stage_read(chunks[slot], state);
+        td::submit(syncs[slot], [c = &chunks[slot]] { stage_process(*c); });
+    }
+
+    // drain in stream order
+    for (auto i = num_chunks > num_tokens ? num_chunks - num_tokens : 0u; i < num_chunks; ++i)
+    {
+        auto const slot = i % num_tokens;
+        td::wait_for(syncs[slot]);
+        stage_write(chunks[slot], total);
+    }
+
+    return total;
+}
+}
+
+TEST("td hand-chained pipeline (bounded tokens)", exclusive)
+{
+    auto const num_threads = unsigned(td::system::num_logical_cores());
+    auto const megabytes = double(num_chunks) * chunk_size / (1024.0 * 1024.0);
+
+    uint64_t expected = 0;
+    auto const t_serial = measure_seconds(num_runs, [&] { expected = run_serial(); });
+    report("td pipeline", "serial", 1, megabytes / t_serial, "MiB/s");
+
+    // every token holds a live td::sync counter, stay well below the configured counter limit
+    td::scheduler_config config;
+    auto const max_num_tokens = unsigned(config.max_num_counters) / 2;
+
+    td::launch(config, [&] {
+        auto last_num_tokens = 0u;
+        for (auto const tokens_per_core : {1u, 2u, 4u})
+        {
+            auto const num_tokens = tokens_per_core * num_threads < max_num_tokens ? tokens_per_core * num_threads : max_num_tokens;
+            if (num_tokens == last_num_tokens)
+                continue;
+            last_num_tokens = num_tokens;
+
+            uint64_t result = 0;
+            auto const t_chained = measure_seconds(num_runs, [&] { result = run_chained(num_tokens); });
+            CHECK(result == expected);
+
+            auto const variant = "hand-chained, " + std::to_string(num_tokens) + " tokens";
+            report("td pipeline", variant, num_threads, megabytes / t_chained, "MiB/s");
+            report("td pipeline in flight", variant, num_threads, double(num_tokens) * chunk_size / (1024.0 * 1024.0), "MiB");
+        }
+    });
+}
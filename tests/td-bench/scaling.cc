@@ -0,0 +1,104 @@
+#include <nexus/test.hh>
+
+#include <atomic>
+#include <vector>
+
+#include <task-dispatcher/common/system_info.hh>
+#include <task-dispatcher/td.hh>
+
+#include "benchmark.hh"
+
+namespace
+{
+// same shape as the td::Scheduler (dependency) test
+auto constexpr workload_size = 5000000u;
+auto constexpr num_chunks = 500u;
+auto constexpr chunk_size = workload_size / num_chunks;
+
+// same shape as outer_task_func in the td::Scheduler test, but wider
+// outer tasks park after submitting, so with a single thread all inner tasks are queued at once
+auto constexpr num_tasks_outer = 16u;
+auto constexpr num_tasks_inner = 64u;
+auto constexpr inner_task_cycles = 2000ull;
+
+auto constexpr num_runs = 5;
+
+void run_flat(std::vector<int>& data)
+{
+    auto s = td::submit_n(
+        [&data](auto i) {
+            auto const chunk_start = unsigned(i) * chunk_size;
+            auto const chunk_end = chunk_start + chunk_size;
+            for (auto j = chunk_start; j < chunk_end; ++j)
+                data[j] = int(j);
+        },
+        num_chunks);
+    td::wait_for(s);
+}
+
+void run_nested(std::atomic_int& counter)
+{
+    // every outer task fans out again, submitting from inside a worker
+    auto s = td::submit_n(
+        [&counter](auto) {
+            auto s_inner = td::submit_n(
+                [&counter](auto) {
+                    spin_cycles(inner_task_cycles);
+                    ++counter;
+                },
+                num_tasks_inner);
+            td::wait_for(s_inner);
+        },
+        num_tasks_outer);
+    td::wait_for(s);
+}
+}
+
+TEST("td scaling (flat and nested fan-out)", exclusive)
+{
+    auto const max_threads = unsigned(td::system::num_logical_cores());
+
+    std::vector<int> data;
+    data.resize(workload_size, 0);
+
+    double time_flat_single = 0.0;
+    double time_nested_single = 0.0;
+
+    for (auto num_threads = 1u; num_threads <= max_threads; ++num_threads)
+    {
+        td::scheduler_config config;
+        config.num_threads = num_threads;
+
+        // Make sure this benchmark does not exceed the configured job limit
+        REQUIRE(num_chunks + 1 < config.max_num_tasks);
+        REQUIRE((num_tasks_inner * num_tasks_outer) + 1 < config.max_num_tasks);
+
+        double time_flat = 0.0;
+        double time_nested = 0.0;
+        std::atomic_int counter = {0};
+
+        td::launch(config, [&] {
+            time_flat = measure_seconds(num_runs, [&] { run_flat(data); });
+            time_nested = measure_seconds(num_runs, [&] { run_nested(counter); });
+        });
+
+        CHECK(counter.load() == int(num_runs * num_tasks_outer * num_tasks_inner));
+
+        if (num_threads == 1)
+        {
+            time_flat_single = time_flat;
+            time_nested_single = time_nested;
+        }
+
+        report("td scaling flat", "time", num_threads, time_flat * 1000.0, "ms");
+        report("td scaling flat", "speedup", num_threads, time_flat_single / time_flat, "x");
+        report("td scaling nested", "time", num_threads, time_nested * 1000.0, "ms");
+        report("td scaling nested", "speedup", num_threads, time_nested_single / time_nested, "x");
+    }
+
+    bool equal = true;
+    for (auto i = 0u; i < workload_size; ++i)
+        equal = equal && data[i] == int(i);
+
+    CHECK(equal);
+}
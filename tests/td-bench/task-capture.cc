@@ -0,0 +1,102 @@
+#include <nexus/test.hh>
+
+#include <atomic>
+#include <memory>
+
+#include <clean-core/array.hh>
+
+#include <task-dispatcher/common/system_info.hh>
+#include <task-dispatcher/td.hh>
+
+#include "benchmark.hh"
+
+namespace
+{
+// captures that fit into td::container::task inline, and ones that don't
+using small_payload = cc::array<int, 10>; // + 8 byte pointer = 48 byte capture
+using large_payload = cc::array<int, 64>; // 256 byte
+
+// submitted in waves to stay well below scheduler_config::max_num_tasks
+auto constexpr num_tasks_per_wave = 512u;
+auto constexpr num_waves = 200u;
+
+auto constexpr num_runs = 5;
+
+template <class Payload>
+Payload make_payload()
+{
+    Payload p;
+    for (auto i = 0u; i < p.size(); ++i)
+        p[i] = int(i);
+    return p;
+}
+
+template <class Payload>
+int sum_payload(Payload const& p)
+{
+    auto sum = 0;
+    for (auto v : p)
+        sum += v;
+    return sum;
+}
+
+void run_small(std::atomic_int& sink)
+{
+    auto const payload = make_payload<small_payload>();
+    for (auto _ = 0u; _ < num_waves; ++_)
+    {
+        td::sync s;
+        for (auto i = 0u; i < num_tasks_per_wave; ++i)
+            td::submit(s, [payload, &sink] { sink += sum_payload(payload); });
+        td::wait_for(s);
+    }
+}
+
+void run_large_heap(std::atomic_int& sink)
+{
+    // the current workaround: move the oversized capture to the heap, one allocation per task
+    auto const payload = make_payload<large_payload>();
+    for (auto _ = 0u; _ < num_waves; ++_)
+    {
+        td::sync s;
+        for (auto i = 0u; i < num_tasks_per_wave; ++i)
+            td::submit(s, [p = std::make_unique<large_payload>(payload), &sink] { sink += sum_payload(*p); });
+        td::wait_for(s);
+    }
+}
+
+void run_large_shared(std::atomic_int& sink)
+{
+    // the other workaround: share one heap payload across all tasks of a wave
+    for (auto _ = 0u; _ < num_waves; ++_)
+    {
+        auto const p = std::make_shared<large_payload>(make_payload<large_payload>());
+
+        td::sync s;
+        for (auto i = 0u; i < num_tasks_per_wave; ++i)
+            td::submit(s, [p, &sink] { sink += sum_payload(*p); });
+        td::wait_for(s);
+    }
+}
+}
+
+TEST("td task capture size (submit cost)", exclusive)
+{
+    static_assert(sizeof(small_payload) + sizeof(void*) == 48, "small capture should be 48 bytes");
+    static_assert(sizeof(large_payload) == 256, "large capture should be 256 bytes");
+
+    auto const num_threads = unsigned(td::system::num_logical_cores());
+    auto constexpr num_tasks = num_waves * num_tasks_per_wave;
+
+    td::launch([&] {
+        std::atomic_int sink = {0};
+
+        auto const t_small = measure_seconds(num_runs, [&] { run_small(sink); });
+        auto const t_large_heap = measure_seconds(num_runs, [&] { run_large_heap(sink); });
+        auto const t_large_shared = measure_seconds(num_runs, [&] { run_large_shared(sink); });
+
+        report("td task capture", "48 byte inline", num_threads, t_small * 1e9 / num_tasks, "ns / task");
+        report("td task capture", "256 byte, unique_ptr per task", num_threads, t_large_heap * 1e9 / num_tasks, "ns / task");
+        report("td task capture", "256 byte, shared_ptr per wave", num_threads, t_large_shared * 1e9 / num_tasks, "ns / task");
+    });
+}